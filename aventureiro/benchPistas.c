@@ -0,0 +1,143 @@
+/* Medição da árvore de pistas (BST) do nível aventureiro.
+
+   Compara o layout atual do PistaNode (filhos + janela de 8 bytes no nó,
+   texto fora dele) com o layout anterior (texto de 100 bytes embutido no nó,
+   comparação por strcmp) em N pistas geradas com palavras do jogo. Os dois
+   layouts alocam os nós de arenas, então só o layout do nó muda entre eles.
+
+   Compilar e rodar a partir da raiz do repositório:
+       gcc -O2 -o benchPistas aventureiro/benchPistas.c
+       ./benchPistas [N]          (padrão: 1000000)
+
+   Os tempos são de CPU (clock) e variam entre máquinas e entre execuções;
+   compare os dois layouts na mesma execução. Falhas de cache não são medidas
+   diretamente: o tempo e a fração de comparações que leem o texto são a
+   aproximação disponível. */
+
+// O jogo é incluído inteiro, com o main renomeado para não conflitar
+#define main mainJogo
+#include "nivelAventureiro.c"
+#undef main
+
+#include <time.h>
+
+/* ============================
+   LAYOUT ANTERIOR (referência)
+   ============================ */
+
+// Nó com o texto embutido: cada comparação lê o texto do nó
+typedef struct PistaEmbutida {
+    char pista[100];
+    struct PistaEmbutida *esquerda;
+    struct PistaEmbutida *direita;
+} PistaEmbutida;
+
+Arena arenaEmbutidas;        // Nós do layout anterior (mesma alocação do layout atual)
+
+PistaEmbutida* inserirPistaEmbutida(PistaEmbutida *raiz, const char *pista) {
+    if (raiz == NULL) {
+        PistaEmbutida *novo = (PistaEmbutida*) arenaAlocar(&arenaEmbutidas, sizeof(PistaEmbutida));
+        strncpy(novo->pista, pista, sizeof(novo->pista) - 1);
+        novo->pista[sizeof(novo->pista) - 1] = '\0';
+        novo->esquerda = novo->direita = NULL;
+        return novo;
+    }
+    int cmp = strcmp(pista, raiz->pista);
+    if (cmp < 0) raiz->esquerda = inserirPistaEmbutida(raiz->esquerda, pista);
+    else if (cmp > 0) raiz->direita = inserirPistaEmbutida(raiz->direita, pista);
+    return raiz;
+}
+
+/* ============================
+   MEDIÇÃO
+   ============================ */
+
+static const char *palavras[] = {
+    "Um", "Uma", "Pegadas", "Marcas", "Carta", "Bilhete", "Retrato", "Lenço",
+    "Chave", "Página", "Faca", "Luva", "Mancha", "Relógio", "Anel", "Frasco"
+};
+
+#define TAM_PISTA 64
+
+double segundos(clock_t inicio) {
+    return (double) (clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+/**
+ * Função: contarLeiturasDoTexto
+ * -----------------------------
+ * Refaz a descida de cada consulta contando quantas comparações
+ * foram resolvidas só pela janela e quantas precisaram ler o texto.
+ */
+void contarLeiturasDoTexto(PistaNode *raiz, char (*pistas)[TAM_PISTA], size_t n,
+                           unsigned long long *comparacoes, unsigned long long *leituras) {
+    for (size_t i = 0; i < n; i++) {
+        const char *pista = pistas[(i * 7919u) % n];
+        PistaNode *no = raiz;
+        while (no) {
+            size_t lcp;
+            (*comparacoes)++;
+            uint64_t w = janelaPista(pista, no->desloc);
+            if (w == no->janela && (w & 0xFF) != 0) (*leituras)++;
+            int cmp = compararPista(pista, no, &lcp);
+            if (cmp == 0) break;
+            no = cmp < 0 ? no->esquerda : no->direita;
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    size_t n = argc > 1 ? (size_t) strtoul(argv[1], NULL, 10) : 1000000;
+    if (n == 0) n = 1;
+
+    char (*pistas)[TAM_PISTA] = malloc(n * sizeof *pistas);
+    if (!pistas) {
+        printf("Erro ao alocar memória para as pistas.\n");
+        return 1;
+    }
+
+    // Gerador congruente fixo: as mesmas pistas em toda execução
+    unsigned x = 12345;
+    for (size_t i = 0; i < n; i++) {
+        x = x * 1103515245u + 12345u;
+        unsigned y = x * 2654435761u;
+        snprintf(pistas[i], TAM_PISTA, "%s %s %s %u",
+                 palavras[(x >> 8) & 15], palavras[(x >> 16) & 15],
+                 palavras[(y >> 20) & 15], y % 1000003u);
+    }
+
+    // Layout atual
+    PistaNode *raiz = NULL;
+    clock_t t = clock();
+    for (size_t i = 0; i < n; i++) raiz = inserirPista(raiz, pistas[i]);
+    double montagem = segundos(t);
+    t = clock();
+    for (size_t i = 0; i < n; i++) raiz = inserirPista(raiz, pistas[(i * 7919u) % n]);
+    double consultas = segundos(t);
+
+    unsigned long long comparacoes = 0, leituras = 0;
+    contarLeiturasDoTexto(raiz, pistas, n, &comparacoes, &leituras);
+
+    // Layout anterior
+    PistaEmbutida *raizEmbutida = NULL;
+    t = clock();
+    for (size_t i = 0; i < n; i++) raizEmbutida = inserirPistaEmbutida(raizEmbutida, pistas[i]);
+    double montagemEmbutida = segundos(t);
+    t = clock();
+    for (size_t i = 0; i < n; i++) raizEmbutida = inserirPistaEmbutida(raizEmbutida, pistas[(i * 7919u) % n]);
+    double consultasEmbutida = segundos(t);
+
+    printf("%zu pistas\n", n);
+    printf("layout         nó     montagem  consultas\n");
+    printf("texto no nó    %3zuB  %7.3fs  %8.3fs\n",
+           sizeof(PistaEmbutida), montagemEmbutida, consultasEmbutida);
+    printf("janela         %3zuB  %7.3fs  %8.3fs\n",
+           sizeof(PistaNode), montagem, consultas);
+    printf("comparações que leram o texto: %.1f%%\n",
+           comparacoes ? 100.0 * leituras / comparacoes : 0.0);
+
+    arenaLiberar(&arenaEmbutidas);
+    liberarPistas(raiz);
+    free(pistas);
+    return 0;
+}
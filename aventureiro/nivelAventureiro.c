@@ -3,6 +3,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <stdint.h>
 
 /* ============================
    ESTRUTURAS DE DADOS
@@ -17,13 +18,110 @@ typedef struct Sala {
 } Sala;
 
 // Estrutura para representar um nó da árvore de pistas (BST)
+// Filhos e janela (consultados a cada comparação) ficam juntos no nó;
+// o texto completo fica fora dele. As pistas da subárvore de um nó
+// compartilham os primeiros 'desloc' bytes, então a janela guarda os
+// 8 bytes seguintes e a comparação quase nunca precisa ler o texto.
 typedef struct PistaNode {
-    char pista[100];
     struct PistaNode *esquerda;
     struct PistaNode *direita;
+    uint64_t janela;         // 8 bytes da pista a partir de 'desloc' (big-endian: ordem de strcmp)
+    uint32_t desloc;         // Prefixo comum da posição do nó na árvore
+    char *pista;             // Texto completo (na arena de textos)
 } PistaNode;
 
 
+/* ============================
+   ARENA DE PISTAS
+   ============================ */
+
+// Cada nó de pista é apenas um avanço de deslocamento dentro de um
+// bloco, e a árvore inteira é liberada de uma vez ao final do jogo.
+#define ARENA_BLOCO 4096
+
+typedef struct ArenaBloco {
+    struct ArenaBloco *prox;
+    size_t usado;
+    size_t capacidade;
+    unsigned char dados[];
+} ArenaBloco;
+
+typedef struct Arena {
+    ArenaBloco *primeiro;    // Cadeia de blocos já alocados
+    ArenaBloco *atual;       // Bloco em uso
+} Arena;
+
+Arena arenaPistas;           // Nós da árvore de pistas da sessão atual
+Arena arenaTextos;           // Textos das pistas (separados para manter os nós contíguos)
+
+/**
+ * Função: criarArenaBloco
+ * -----------------------
+ * Aloca um bloco com capacidade para, no mínimo, 'minimo' bytes.
+ */
+ArenaBloco* criarArenaBloco(size_t minimo) {
+    size_t capacidade = minimo > ARENA_BLOCO ? minimo : ARENA_BLOCO;
+    ArenaBloco *bloco = (ArenaBloco*) malloc(sizeof(ArenaBloco) + capacidade);
+    if (!bloco) {
+        printf("Erro ao alocar memória para a arena.\n");
+        exit(1);
+    }
+    bloco->prox = NULL;
+    bloco->usado = 0;
+    bloco->capacidade = capacidade;
+    return bloco;
+}
+
+/**
+ * Função: arenaAlocar
+ * -------------------
+ * Reserva 'tamanho' bytes alinhados na arena. Só recorre ao malloc
+ * quando o bloco atual não comporta a alocação.
+ */
+void* arenaAlocar(Arena *arena, size_t tamanho) {
+    const size_t alinhamento = sizeof(void*) > sizeof(double) ? sizeof(void*) : sizeof(double);
+    tamanho = (tamanho + alinhamento - 1) & ~(alinhamento - 1);
+
+    if (arena->atual == NULL || arena->atual->capacidade - arena->atual->usado < tamanho) {
+        ArenaBloco *novo = criarArenaBloco(tamanho);
+        if (arena->atual) arena->atual->prox = novo;
+        else arena->primeiro = novo;
+        arena->atual = novo;
+    }
+
+    void *p = arena->atual->dados + arena->atual->usado;
+    arena->atual->usado += tamanho;
+    return p;
+}
+
+/**
+ * Função: arenaStrdup
+ * -------------------
+ * Copia uma string para dentro da arena.
+ */
+char* arenaStrdup(Arena *arena, const char *str) {
+    size_t n = strlen(str) + 1;
+    char *copia = (char*) arenaAlocar(arena, n);
+    memcpy(copia, str, n);
+    return copia;
+}
+
+/**
+ * Função: arenaLiberar
+ * --------------------
+ * Devolve todos os blocos ao sistema ao encerrar o programa.
+ */
+void arenaLiberar(Arena *arena) {
+    ArenaBloco *bloco = arena->primeiro;
+    while (bloco) {
+        ArenaBloco *tmp = bloco;
+        bloco = bloco->prox;
+        free(tmp);
+    }
+    arena->primeiro = arena->atual = NULL;
+}
+
+
 /* ============================
    FUNÇÕES DE CRIAÇÃO
    ============================ */
@@ -47,20 +145,33 @@ Sala* criarSala(const char *nome, const char *pista) {
     return nova;
 }
 
+/**
+ * Função: janelaPista
+ * -------------------
+ * Empacota 8 bytes da pista a partir de 'desloc' em big-endian (zeros
+ * após o fim), de modo que comparar janelas como inteiros segue strcmp.
+ */
+uint64_t janelaPista(const char *pista, size_t desloc) {
+    uint64_t w = 0;
+    int i = 0;
+    pista += desloc;
+    for (; i < 8 && pista[i]; i++) w = (w << 8) | (unsigned char) pista[i];
+    return i ? w << (8 * (8 - i)) : 0;   // i == 0: pista já terminou
+}
+
 /**
  * Função: criarPistaNode
  * ----------------------
  * Cria um novo nó na árvore de pistas com a string fornecida.
+ * O nó é alocado na arena da sessão e o texto na arena de textos.
  */
-PistaNode* criarPistaNode(const char *pista) {
-    PistaNode *novo = (PistaNode*) malloc(sizeof(PistaNode));
-    if (!novo) {
-        printf("Erro ao alocar memória para a pista.\n");
-        exit(1);
-    }
-    strcpy(novo->pista, pista);
+PistaNode* criarPistaNode(const char *pista, size_t desloc) {
+    PistaNode *novo = (PistaNode*) arenaAlocar(&arenaPistas, sizeof(PistaNode));
     novo->esquerda = NULL;
     novo->direita = NULL;
+    novo->janela = janelaPista(pista, desloc);
+    novo->desloc = (uint32_t) desloc;
+    novo->pista = arenaStrdup(&arenaTextos, pista);
     return novo;
 }
 
@@ -69,21 +180,72 @@ PistaNode* criarPistaNode(const char *pista) {
    FUNÇÕES DE MANIPULAÇÃO DA BST
    ============================ */
 
+/**
+ * Função: primeiroByteDiferente
+ * -----------------------------
+ * Índice (0 a 7) do primeiro byte diferente entre duas janelas (x = a ^ b).
+ */
+int primeiroByteDiferente(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clzll(x) / 8;
+#else
+    int i = 0;
+    while (!(x & 0xFF00000000000000ull)) { x <<= 8; i++; }
+    return i;
+#endif
+}
+
+/**
+ * Função: compararPista
+ * ---------------------
+ * Compara a pista com o nó na ordem de strcmp e devolve em '*lcp' o
+ * tamanho do prefixo comum. O texto do nó só é lido quando as janelas
+ * empatam e a pista continua além delas.
+ */
+int compararPista(const char *pista, const PistaNode *no, size_t *lcp) {
+    uint64_t w = janelaPista(pista, no->desloc);
+    if (w != no->janela) {
+        *lcp = no->desloc + primeiroByteDiferente(w ^ no->janela);
+        return w < no->janela ? -1 : 1;
+    }
+    if ((w & 0xFF) == 0) {   // A pista termina dentro da janela: são iguais
+        *lcp = no->desloc + 8;
+        return 0;
+    }
+    size_t i = no->desloc + 8;
+    while (pista[i] && pista[i] == no->pista[i]) i++;
+    *lcp = i;
+    return (unsigned char) pista[i] - (unsigned char) no->pista[i];
+}
+
+/**
+ * Função: inserirPistaLcp
+ * -----------------------
+ * Inserção recursiva que acompanha o prefixo comum da pista com os
+ * limites inferior (lcpInf) e superior (lcpSup) da subárvore; o menor
+ * deles é o 'desloc' do novo nó.
+ */
+PistaNode* inserirPistaLcp(PistaNode *raiz, const char *pista, size_t lcpInf, size_t lcpSup) {
+    if (raiz == NULL)
+        return criarPistaNode(pista, lcpInf < lcpSup ? lcpInf : lcpSup);
+
+    size_t lcp;
+    int cmp = compararPista(pista, raiz, &lcp);
+    if (cmp < 0)
+        raiz->esquerda = inserirPistaLcp(raiz->esquerda, pista, lcpInf, lcp);
+    else if (cmp > 0)
+        raiz->direita = inserirPistaLcp(raiz->direita, pista, lcp, lcpSup);
+    // Se for igual, não insere duplicado
+    return raiz;
+}
+
 /**
  * Função: inserirPista
  * --------------------
  * Insere uma nova pista na árvore BST em ordem alfabética.
  */
 PistaNode* inserirPista(PistaNode *raiz, const char *pista) {
-    if (raiz == NULL)
-        return criarPistaNode(pista);
-
-    if (strcmp(pista, raiz->pista) < 0)
-        raiz->esquerda = inserirPista(raiz->esquerda, pista);
-    else if (strcmp(pista, raiz->pista) > 0)
-        raiz->direita = inserirPista(raiz->direita, pista);
-    // Se for igual, não insere duplicado
-    return raiz;
+    return inserirPistaLcp(raiz, pista, 0, 0);
 }
 
 /**
@@ -99,6 +261,18 @@ void exibirPistas(PistaNode *raiz) {
     }
 }
 
+/**
+ * Função: liberarPistas
+ * ---------------------
+ * Libera a árvore de pistas. Como nós e textos estão nas arenas,
+ * basta devolver os blocos delas, sem percorrer a árvore.
+ */
+void liberarPistas(PistaNode *raiz) {
+    (void) raiz;
+    arenaLiberar(&arenaPistas);
+    arenaLiberar(&arenaTextos);
+}
+
 
 /* ============================
    FUNÇÃO DE EXPLORAÇÃO
@@ -211,7 +385,7 @@ int main() {
     free(cozinha);
     free(salaEstar);
     free(hall);
-    // (para a árvore de pistas, omissão aceitável para fins didáticos)
+    liberarPistas(arvorePistas);
 
     return 0;
 }
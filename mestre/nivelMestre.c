@@ -1,38 +1,163 @@
+/* fileno/fsync/open (diário de sessão) também com -std=c99/c11 */
+#define _POSIX_C_SOURCE 200809L
+
 /* bibliotecas */
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <stdint.h>
+#include <errno.h>
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#define sincronizarArquivo(fd) _commit(fd)
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#define sincronizarArquivo(fd) fsync(fd)
+#endif
+
+/* Compilar com -DCASO_FIXO usa o catálogo pista -> suspeito deste caso
+   como hash perfeita mínima gerada previamente (sem inserções em tempo de execução).
+   Compilar com -DGERAR_CASO_FIXO e executar imprime essa tabela a partir de
+   catalogoCaso, para colar na seção CATÁLOGO FIXO. */
+#if defined(CASO_FIXO) && defined(GERAR_CASO_FIXO)
+#error "CASO_FIXO e GERAR_CASO_FIXO são exclusivos: o gerador usa a tabela hash em tempo de execução"
+#endif
 
 /* =========================
    DEFINIÇÕES E ESTRUTURAS
    ========================= */
 
+/* Resumo de evidências: cada pista do catálogo recebe um id, que é um bit da máscara */
+// Limites das dicas: só as primeiras 64 pistas e 16 suspeitos do catálogo recebem bit/máscara.
+// O catálogo em si não tem limite; além disso, exibirDicas informa que as dicas estão indisponíveis.
+#define MAX_PISTAS 64
+#define MAX_SUSPEITOS 16
+typedef uint64_t MascaraPistas;
+
 /* Estrutura que representa uma sala (nó da árvore binária) */
 typedef struct Sala {
     char nome[64];           // identificador da sala
     char pista[200];         // pista associada (pode ser string vazia)
     struct Sala *esquerda;
     struct Sala *direita;
+    struct Sala *pai;        // sala de origem (usada para propagar resumos)
+    MascaraPistas resumo;    // pistas distintas do catálogo nesta sala e abaixo dela
 } Sala;
 
 /* Nó da BST que armazena pistas coletadas em ordem alfabética */
 typedef struct PistaNode {
-    char *pista;                // string alocada dinamicamente
+    char *pista;                // texto da pista (na arena da sessão)
+    unsigned long hash;         // hashPista(pista), reaproveitado na consulta ao catálogo
     struct PistaNode *esq;
     struct PistaNode *dir;
 } PistaNode;
 
-/* Nó para cadeias na tabela hash (encadeamento separado) */
+#ifndef CASO_FIXO
+/* Nó para cadeias na tabela hash (encadeamento separado).
+   O hash completo da chave fica no nó: colisões de balde são descartadas sem strcmp. */
 typedef struct HashNode {
+    struct HashNode *next;
+    unsigned long hash;    // hash completo da chave
     char *chave;           // pista (chave)
     char *suspeito;        // suspeito associado à pista (valor)
-    struct HashNode *next;
+    int idPista;           // bit da pista nas máscaras de resumo
 } HashNode;
 
 /* Tabela hash simples */
 #define HASH_SIZE 101  // tamanho razoável para poucos elementos
 HashNode *hashTable[HASH_SIZE];
+#endif
+
+/* =========================
+   ARENA (alocador por região)
+   ---------------------------
+   Blocos grandes alocados uma única vez e reaproveitados entre sessões.
+   Cada alocação apenas avança um deslocamento dentro do bloco atual;
+   arenaReiniciar() devolve tudo de uma vez em O(1), sem free por nó.
+   ========================= */
+#define ARENA_BLOCO 4096
+
+typedef struct ArenaBloco {
+    struct ArenaBloco *prox;
+    size_t usado;
+    size_t capacidade;
+    unsigned char dados[];
+} ArenaBloco;
+
+typedef struct Arena {
+    ArenaBloco *primeiro;   // cadeia de blocos (mantida entre sessões)
+    ArenaBloco *atual;      // bloco onde as alocações estão ocorrendo
+} Arena;
+
+#ifndef CASO_FIXO
+Arena arenaCaso;     // catálogo pista -> suspeito (vive durante todo o programa)
+#endif
+Arena arenaSessao;   // pistas coletadas em uma sessão de jogo
+
+/* Cria um bloco com capacidade para ao menos 'minimo' bytes */
+ArenaBloco* criarArenaBloco(size_t minimo) {
+    size_t capacidade = minimo > ARENA_BLOCO ? minimo : ARENA_BLOCO;
+    ArenaBloco *b = (ArenaBloco*) malloc(sizeof(ArenaBloco) + capacidade);
+    if (!b) { fprintf(stderr,"Erro: malloc criarArenaBloco\n"); exit(EXIT_FAILURE); }
+    b->prox = NULL;
+    b->usado = 0;
+    b->capacidade = capacidade;
+    return b;
+}
+
+/* arenaAlocar - reserva 'tamanho' bytes alinhados; só chama malloc ao esgotar os blocos já existentes */
+void* arenaAlocar(Arena *a, size_t tamanho) {
+    const size_t alinhamento = sizeof(void*) > sizeof(double) ? sizeof(void*) : sizeof(double);
+    tamanho = (tamanho + alinhamento - 1) & ~(alinhamento - 1);
+
+    if (!a->atual) {
+        a->primeiro = a->atual = criarArenaBloco(tamanho);
+    }
+    while (a->atual->capacidade - a->atual->usado < tamanho) {
+        ArenaBloco *prox = a->atual->prox;
+        if (!prox || prox->capacidade < tamanho) {
+            // bloco novo (ou maior) inserido logo após o atual
+            ArenaBloco *novo = criarArenaBloco(tamanho);
+            novo->prox = prox;
+            a->atual->prox = novo;
+            prox = novo;
+        }
+        prox->usado = 0;   // blocos reaproveitados são zerados ao serem alcançados
+        a->atual = prox;
+    }
+
+    void *p = a->atual->dados + a->atual->usado;
+    a->atual->usado += tamanho;
+    return p;
+}
+
+/* arenaStrdup - cópia de string alocada na arena */
+char* arenaStrdup(Arena *a, const char *str) {
+    size_t n = strlen(str) + 1;
+    char *copia = (char*) arenaAlocar(a, n);
+    memcpy(copia, str, n);
+    return copia;
+}
+
+/* arenaReiniciar - descarta todas as alocações em O(1), mantendo os blocos para a próxima sessão */
+void arenaReiniciar(Arena *a) {
+    a->atual = a->primeiro;
+    if (a->atual) a->atual->usado = 0;
+}
+
+/* arenaLiberar - devolve os blocos ao sistema (apenas ao encerrar o programa) */
+void arenaLiberar(Arena *a) {
+    ArenaBloco *b = a->primeiro;
+    while (b) {
+        ArenaBloco *tmp = b;
+        b = b->prox;
+        free(tmp);
+    }
+    a->primeiro = a->atual = NULL;
+}
 
 /* =========================
    FUNÇÃO: criarSala
@@ -48,9 +173,10 @@ Sala* criarSala(const char *nome, const char *pista) {
     }
     strncpy(s->nome, nome, sizeof(s->nome)-1);
     s->nome[sizeof(s->nome)-1] = '\0';
-    strncpy(s->pista, pista, sizeof(s->pista)-1);
-    s->pista[sizeof(s->pista)-1] = '\0';
-    s->esquerda = s->direita = NULL;
+    s->esquerda = s->direita = s->pai = NULL;
+    s->resumo = 0;   // preenchido por conectarSalas/calcularResumos
+    extern void definirPistaSala(Sala *s, const char *pista); // forward
+    definirPistaSala(s, pista);
     return s;
 }
 
@@ -58,11 +184,12 @@ Sala* criarSala(const char *nome, const char *pista) {
    FUNÇÕES BST (pistas)
    ========================= */
 
-/* Cria nó de pista */
+/* Cria nó de pista (na arena da sessão) */
 PistaNode* criarPistaBST(const char *pista) {
-    PistaNode *n = (PistaNode*) malloc(sizeof(PistaNode));
-    if (!n) { fprintf(stderr,"Erro: malloc criarPistaBST\n"); exit(EXIT_FAILURE); }
-    n->pista = strdup(pista);
+    extern unsigned long hashPista(const char *pista); // forward
+    PistaNode *n = (PistaNode*) arenaAlocar(&arenaSessao, sizeof(PistaNode));
+    n->pista = arenaStrdup(&arenaSessao, pista);
+    n->hash = hashPista(pista);
     n->esq = n->dir = NULL;
     return n;
 }
@@ -94,9 +221,9 @@ int contarPistasParaSuspeito(PistaNode *raiz, const char *suspeitoAcusado) {
     // verificar esquerda
     count += contarPistasParaSuspeito(raiz->esq, suspeitoAcusado);
     // verificar o nó atual: procurar suspeito na tabela hash
-    // função encontrarSuspeito será usada (declaração abaixo)
-    extern char* encontrarSuspeito(const char *pista); // forward
-    char *s = encontrarSuspeito(raiz->pista);
+    // função encontrarSuspeitoPorHash será usada (declaração abaixo); o hash já está no nó
+    extern const char* encontrarSuspeitoPorHash(const char *pista, unsigned long hash); // forward
+    const char *s = encontrarSuspeitoPorHash(raiz->pista, raiz->hash);
     if (s != NULL) {
         // comparar nomes ignorando maiúsculas/minúsculas
         char a[100], b[100];
@@ -112,19 +239,160 @@ int contarPistasParaSuspeito(PistaNode *raiz, const char *suspeitoAcusado) {
     return count;
 }
 
-/* Libera memória da BST de pistas */
+/* Libera a BST de pistas: todos os nós vivem na arena da sessão, então basta reiniciá-la */
 void liberarPistasBST(PistaNode *raiz) {
-    if (!raiz) return;
-    liberarPistasBST(raiz->esq);
-    liberarPistasBST(raiz->dir);
-    free(raiz->pista);
-    free(raiz);
+    (void) raiz;
+    arenaReiniciar(&arenaSessao);
 }
 
 /* =========================
    FUNÇÕES TABELA HASH
    ========================= */
 
+/* nomesIguais - compara nomes de suspeitos ignorando maiúsculas/minúsculas */
+int nomesIguais(const char *a, const char *b) {
+    while (*a && tolower((unsigned char)*a) == tolower((unsigned char)*b)) { a++; b++; }
+    return tolower((unsigned char)*a) == tolower((unsigned char)*b);
+}
+
+/* Catálogo do caso: cada pista do mapa e o suspeito para o qual ela aponta.
+   Fonte única: main() monta a tabela hash a partir dele, gerarCasoFixo() gera
+   a tabela fixa e verificarCatalogoFixo() confere a tabela fixa contra ele. */
+typedef struct PistaCatalogo {
+    const char *pista;
+    const char *suspeito;
+} PistaCatalogo;
+
+static const PistaCatalogo catalogoCaso[] = {
+    { "A chave do escritório está faltando.", "Eleanor" },
+    { "Um retrato com uma mancha vermelha.", "Carlos" },
+    { "Pegadas de lama perto da janela.", "Marta R." },
+    { "Página rasgada mencionando \"Eleanor\".", "Eleanor" },
+    { "Um lenço com as iniciais 'M.R.'", "Marta R." },
+    { "Marcas de ferramentas próximas ao cofre.", "Carlos" },
+    { "Um bilhete com a assinatura 'Marta R.'", "Marta R." },
+};
+#define TOTAL_CATALOGO ((int) (sizeof(catalogoCaso) / sizeof(catalogoCaso[0])))
+
+#if defined(CASO_FIXO) || defined(GERAR_CASO_FIXO)
+/* FNV-1a de 32 bits com semente (mesmo resultado em qualquer plataforma) */
+uint32_t hash_fnv1a(uint32_t semente, const char *str) {
+    uint32_t hash = 2166136261u ^ semente;
+    int c;
+    while ((c = (unsigned char)*str++)) {
+        hash ^= (uint32_t) c;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+#endif
+
+#ifdef CASO_FIXO
+
+/* =========================
+   CATÁLOGO FIXO (hash perfeita mínima)
+   ------------------------------------
+   As pistas do caso são conhecidas na compilação. A semente faz com que
+   fnv1a(semente, pista) % CASO_FIXO_TAM seja distinto para cada pista, então
+   cada posição guarda exatamente uma entrada: a busca é um hash e um strcmp
+   (checagem da chave), sem cadeias nem alocação.
+   Trecho gerado por gerarCasoFixo() (build com -DGERAR_CASO_FIXO): ao alterar
+   catalogoCaso, gere-o de novo. verificarCatalogoFixo() recusa, na partida,
+   uma tabela que não corresponda a catalogoCaso ou às pistas das salas.
+   ========================= */
+#define CASO_FIXO_TAM 7
+#define CASO_FIXO_SEMENTE 58u
+
+typedef struct EntradaFixa {
+    const char *chave;
+    const char *suspeito;
+} EntradaFixa;
+
+static const EntradaFixa catalogoFixo[CASO_FIXO_TAM] = {
+    /* 0 */ { "Marcas de ferramentas próximas ao cofre.", "Carlos" },
+    /* 1 */ { "Um lenço com as iniciais 'M.R.'", "Marta R." },
+    /* 2 */ { "Um retrato com uma mancha vermelha.", "Carlos" },
+    /* 3 */ { "Pegadas de lama perto da janela.", "Marta R." },
+    /* 4 */ { "Um bilhete com a assinatura 'Marta R.'", "Marta R." },
+    /* 5 */ { "A chave do escritório está faltando.", "Eleanor" },
+    /* 6 */ { "Página rasgada mencionando \"Eleanor\".", "Eleanor" },
+};
+
+/* Suspeitos do caso e as posições (bits) das pistas que apontam para cada um */
+static const int totalSuspeitos = 3;
+static const char *const nomesSuspeitos[MAX_SUSPEITOS] = { "Eleanor", "Carlos", "Marta R." };
+static const MascaraPistas pistasDoSuspeito[MAX_SUSPEITOS] = { 0x60, 0x5, 0x1a };
+
+/* A tabela fixa sempre cabe nas máscaras (gerarCasoFixo recusa catálogos maiores) */
+static const int dicasDisponiveis = 1;
+
+/* hashPista - hash usado pelo catálogo (também guardado em cada PistaNode) */
+unsigned long hashPista(const char *pista) {
+    return hash_fnv1a(CASO_FIXO_SEMENTE, pista);
+}
+
+/* idDaPistaPorHash - a posição da pista é o seu id; a comparação rejeita pistas fora do catálogo */
+int idDaPistaPorHash(const char *pista, unsigned long hash) {
+    uint32_t i = (uint32_t) hash % CASO_FIXO_TAM;
+    return strcmp(catalogoFixo[i].chave, pista) == 0 ? (int) i : -1;
+}
+
+int idDaPista(const char *pista) {
+    return idDaPistaPorHash(pista, hashPista(pista));
+}
+
+/* encontrarSuspeitoPorHash - uma posição por pista: um hash (já calculado) e uma comparação */
+const char* encontrarSuspeitoPorHash(const char *pista, unsigned long hash) {
+    int id = idDaPistaPorHash(pista, hash);
+    return id >= 0 ? catalogoFixo[id].suspeito : NULL;
+}
+
+const char* encontrarSuspeito(const char *pista) {
+    return encontrarSuspeitoPorHash(pista, hashPista(pista));
+}
+
+/* salasNoCatalogo - confere se a pista de cada sala do mapa está na tabela fixa */
+int salasNoCatalogo(const Sala *s) {
+    if (!s) return 1;
+    if (s->pista[0] != '\0' && idDaPista(s->pista) < 0) {
+        fprintf(stderr, "Erro: pista da sala '%s' ausente do catálogo fixo\n", s->nome);
+        return 0;
+    }
+    return salasNoCatalogo(s->esquerda) && salasNoCatalogo(s->direita);
+}
+
+/* verificarCatalogoFixo - confere se a tabela traz exatamente as entradas de catalogoCaso
+   (mesma pista, mesmo suspeito), se a semente ainda separa todas as pistas, se as
+   máscaras de suspeitos batem com a tabela e se toda pista do mapa está no catálogo */
+int verificarCatalogoFixo(const Sala *mapa) {
+    if (TOTAL_CATALOGO != CASO_FIXO_TAM) {
+        fprintf(stderr, "Erro: catálogo fixo com %d pistas, catalogoCaso com %d\n", CASO_FIXO_TAM, TOTAL_CATALOGO);
+        return 0;
+    }
+    for (int i = 0; i < TOTAL_CATALOGO; ++i) {
+        int id = idDaPista(catalogoCaso[i].pista);
+        if (id < 0 || strcmp(catalogoFixo[id].suspeito, catalogoCaso[i].suspeito) != 0) {
+            fprintf(stderr, "Erro: pista \"%s\" ausente ou com outro suspeito no catálogo fixo\n", catalogoCaso[i].pista);
+            return 0;
+        }
+    }
+    for (int i = 0; i < CASO_FIXO_TAM; ++i) {
+        if (hash_fnv1a(CASO_FIXO_SEMENTE, catalogoFixo[i].chave) % CASO_FIXO_TAM != (uint32_t) i)
+            return 0;
+        int dono = 0;
+        for (int j = 0; j < totalSuspeitos; ++j) {
+            if (pistasDoSuspeito[j] & ((MascaraPistas)1 << i)) {
+                if (!nomesIguais(nomesSuspeitos[j], catalogoFixo[i].suspeito)) return 0;
+                dono++;
+            }
+        }
+        if (dono != 1) return 0;
+    }
+    return salasNoCatalogo(mapa);
+}
+
+#else
+
 /* djb2 hash function (strings) */
 unsigned long hash_djb2(const char *str) {
     unsigned long hash = 5381;
@@ -134,54 +402,564 @@ unsigned long hash_djb2(const char *str) {
     return hash;
 }
 
-/* inserirNaHash - insere associação pista -> suspeito */
+/* Suspeitos registrados pelo catálogo e as pistas (bits) que apontam para cada um */
+int totalPistas = 0;
+int totalSuspeitos = 0;
+const char *nomesSuspeitos[MAX_SUSPEITOS];
+MascaraPistas pistasDoSuspeito[MAX_SUSPEITOS];
+int dicasDisponiveis = 1;   // 0 quando alguma pista ou suspeito ficou sem bit/máscara
+
+/* registrarSuspeito - devolve o índice do suspeito, cadastrando-o se ainda não existir
+   (-1 se já houver MAX_SUSPEITOS: o suspeito fica fora das dicas, não do catálogo) */
+int registrarSuspeito(const char *nome) {
+    for (int i = 0; i < totalSuspeitos; ++i)
+        if (nomesIguais(nomesSuspeitos[i], nome)) return i;
+    if (totalSuspeitos >= MAX_SUSPEITOS) {
+        dicasDisponiveis = 0;
+        return -1;
+    }
+    nomesSuspeitos[totalSuspeitos] = nome;
+    pistasDoSuspeito[totalSuspeitos] = 0;
+    return totalSuspeitos++;
+}
+
+/* hashPista - hash usado pelo catálogo (também guardado em cada PistaNode) */
+unsigned long hashPista(const char *pista) {
+    return hash_djb2(pista);
+}
+
+/* inserirNaHash - insere associação pista -> suspeito.
+   Pistas além de MAX_PISTAS entram no catálogo sem bit de resumo (idPista = -1). */
 void inserirNaHash(const char *pista, const char *suspeito) {
-    unsigned long h = hash_djb2(pista) % HASH_SIZE;
-    HashNode *node = (HashNode*) malloc(sizeof(HashNode));
-    if (!node) { fprintf(stderr,"Erro: malloc inserirNaHash\n"); exit(EXIT_FAILURE); }
-    node->chave = strdup(pista);
-    node->suspeito = strdup(suspeito);
+    unsigned long hash = hashPista(pista);
+    unsigned long h = hash % HASH_SIZE;
+    HashNode *node = (HashNode*) arenaAlocar(&arenaCaso, sizeof(HashNode));
+    node->hash = hash;
+    node->chave = arenaStrdup(&arenaCaso, pista);
+    node->suspeito = arenaStrdup(&arenaCaso, suspeito);
+    node->idPista = -1;
+    if (totalPistas < MAX_PISTAS) node->idPista = totalPistas++;
+    else dicasDisponiveis = 0;
+    int idSuspeito = registrarSuspeito(node->suspeito);
+    if (node->idPista >= 0 && idSuspeito >= 0)
+        pistasDoSuspeito[idSuspeito] |= (MascaraPistas)1 << node->idPista;
     node->next = hashTable[h];
     hashTable[h] = node;
+
+    // se os resumos já foram calculados, atualizar as salas que contêm esta pista
+    extern void atualizarSalasComPista(Sala *raiz, const char *pista); // forward
+    extern Sala *mapaResumido;
+    if (mapaResumido) atualizarSalasComPista(mapaResumido, node->chave);
 }
 
-/* encontrarSuspeito - retorna o suspeito associado a uma pista (ou NULL se não existir) */
-char* encontrarSuspeito(const char *pista) {
-    unsigned long h = hash_djb2(pista) % HASH_SIZE;
-    HashNode *cur = hashTable[h];
+/* buscarNaHash - retorna o nó da pista (ou NULL se não existir); só chama strcmp se o hash bater */
+HashNode* buscarNaHash(const char *pista, unsigned long hash) {
+    HashNode *cur = hashTable[hash % HASH_SIZE];
     while (cur) {
-        if (strcmp(cur->chave, pista) == 0) return cur->suspeito;
+        if (cur->hash == hash && strcmp(cur->chave, pista) == 0) return cur;
         cur = cur->next;
     }
     return NULL;
 }
 
-/* Libera toda a tabela hash */
+/* encontrarSuspeitoPorHash - como encontrarSuspeito, reaproveitando um hash já calculado */
+const char* encontrarSuspeitoPorHash(const char *pista, unsigned long hash) {
+    HashNode *node = buscarNaHash(pista, hash);
+    return node ? node->suspeito : NULL;
+}
+
+/* encontrarSuspeito - retorna o suspeito associado a uma pista (ou NULL se não existir) */
+const char* encontrarSuspeito(const char *pista) {
+    return encontrarSuspeitoPorHash(pista, hashPista(pista));
+}
+
+/* idDaPista - bit da pista nas máscaras de resumo (ou -1 se não estiver no catálogo ou não tiver bit) */
+int idDaPista(const char *pista) {
+    HashNode *node = buscarNaHash(pista, hashPista(pista));
+    return node ? node->idPista : -1;
+}
+
+/* Libera toda a tabela hash (nós e strings estão na arena do caso) */
 void liberarHash() {
-    for (int i = 0; i < HASH_SIZE; ++i) {
-        HashNode *cur = hashTable[i];
-        while (cur) {
-            HashNode *tmp = cur;
-            cur = cur->next;
-            free(tmp->chave);
-            free(tmp->suspeito);
-            free(tmp);
+    for (int i = 0; i < HASH_SIZE; ++i) hashTable[i] = NULL;
+    totalPistas = totalSuspeitos = 0;
+    dicasDisponiveis = 1;
+    arenaReiniciar(&arenaCaso);
+}
+
+#ifdef GERAR_CASO_FIXO
+/* imprimirLiteralC - imprime a string como literal C (escapando aspas e barras) */
+void imprimirLiteralC(const char *str) {
+    putchar('"');
+    for (; *str; ++str) {
+        if (*str == '"' || *str == '\\') putchar('\\');
+        putchar(*str);
+    }
+    putchar('"');
+}
+
+/* gerarCasoFixo - procura a menor semente que leva cada pista do catálogo a uma posição
+   distinta (hash perfeita mínima) e imprime o trecho da seção CATÁLOGO FIXO.
+   Busca por força bruta: viável para catálogos pequenos (até cerca de 12 pistas). */
+int gerarCasoFixo(void) {
+    const int n = TOTAL_CATALOGO;
+    if (n > MAX_PISTAS) { fprintf(stderr, "Erro: catálogo com mais de %d pistas\n", MAX_PISTAS); return 0; }
+
+    const uint32_t limite = 100000000u;
+    for (uint32_t semente = 0; semente < limite; ++semente) {
+        MascaraPistas ocupadas = 0;
+        int ok = 1;
+        for (int i = 0; i < n && ok; ++i) {
+            MascaraPistas bit = (MascaraPistas)1 << (hash_fnv1a(semente, catalogoCaso[i].pista) % (uint32_t) n);
+            if (ocupadas & bit) ok = 0;
+            ocupadas |= bit;
+        }
+        if (!ok) continue;
+
+        const char *porPosicao[MAX_PISTAS];
+        const char *suspeitoPorPosicao[MAX_PISTAS];
+        MascaraPistas mascaras[MAX_SUSPEITOS] = {0};
+        for (int i = 0; i < n; ++i) {
+            int pos = (int) (hash_fnv1a(semente, catalogoCaso[i].pista) % (uint32_t) n);
+            porPosicao[pos] = catalogoCaso[i].pista;
+            suspeitoPorPosicao[pos] = catalogoCaso[i].suspeito;
+            int idSuspeito = registrarSuspeito(catalogoCaso[i].suspeito);
+            if (idSuspeito < 0) { fprintf(stderr, "Erro: catálogo com mais de %d suspeitos\n", MAX_SUSPEITOS); return 0; }
+            mascaras[idSuspeito] |= (MascaraPistas)1 << pos;
+        }
+
+        printf("#define CASO_FIXO_TAM %d\n#define CASO_FIXO_SEMENTE %uu\n\n", n, (unsigned) semente);
+        printf("typedef struct EntradaFixa {\n    const char *chave;\n    const char *suspeito;\n} EntradaFixa;\n\n");
+        printf("static const EntradaFixa catalogoFixo[CASO_FIXO_TAM] = {\n");
+        for (int i = 0; i < n; ++i) {
+            printf("    /* %d */ { ", i);
+            imprimirLiteralC(porPosicao[i]);
+            printf(", ");
+            imprimirLiteralC(suspeitoPorPosicao[i]);
+            printf(" },\n");
+        }
+        printf("};\n\n/* Suspeitos do caso e as posições (bits) das pistas que apontam para cada um */\n");
+        printf("static const int totalSuspeitos = %d;\n", totalSuspeitos);
+        printf("static const char *const nomesSuspeitos[MAX_SUSPEITOS] = { ");
+        for (int i = 0; i < totalSuspeitos; ++i) {
+            imprimirLiteralC(nomesSuspeitos[i]);
+            printf(i + 1 < totalSuspeitos ? ", " : " };\n");
         }
-        hashTable[i] = NULL;
+        printf("static const MascaraPistas pistasDoSuspeito[MAX_SUSPEITOS] = { ");
+        for (int i = 0; i < totalSuspeitos; ++i)
+            printf(i + 1 < totalSuspeitos ? "0x%llx, " : "0x%llx };\n", (unsigned long long) mascaras[i]);
+        return 1;
     }
+    fprintf(stderr, "Erro: nenhuma semente encontrada para %d pistas\n", n);
+    return 0;
+}
+#endif /* GERAR_CASO_FIXO */
+
+#endif /* CASO_FIXO */
+
+/* =========================
+   RESUMOS DE EVIDÊNCIA POR SUBÁRVORE
+   ----------------------------------
+   Cada sala guarda em 'resumo' a máscara das pistas distintas do catálogo
+   presentes nela e em todas as salas abaixo. As pistas contra um suspeito
+   em um ramo são resumo & pistasDoSuspeito[s], contadas em O(1).
+   ========================= */
+
+/* contarBits - quantidade de bits ligados na máscara */
+int contarBits(MascaraPistas m) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(m);
+#else
+    int n = 0;
+    while (m) { m &= m - 1; n++; }
+    return n;
+#endif
+}
+
+/* mascaraDaSala - bit da pista da própria sala (0 se não houver pista no catálogo) */
+MascaraPistas mascaraDaSala(const Sala *s) {
+    if (s->pista[0] == '\0') return 0;
+    int id = idDaPista(s->pista);
+    return id >= 0 ? (MascaraPistas)1 << id : 0;
+}
+
+/* Raiz do mapa cujos resumos já foram calculados (para refletir inserções posteriores no catálogo) */
+Sala *mapaResumido = NULL;
+
+/* calcularResumosSubarvore - passagem única pós-ordem que recalcula o resumo de todas as salas */
+MascaraPistas calcularResumosSubarvore(Sala *raiz) {
+    if (!raiz) return 0;
+    raiz->resumo = mascaraDaSala(raiz)
+                 | calcularResumosSubarvore(raiz->esquerda)
+                 | calcularResumosSubarvore(raiz->direita);
+    return raiz->resumo;
+}
+
+/* calcularResumos - calcula os resumos do mapa; a partir daí o catálogo os mantém atualizados */
+MascaraPistas calcularResumos(Sala *raiz) {
+    mapaResumido = raiz;
+    return calcularResumosSubarvore(raiz);
+}
+
+/* atualizarResumos - recalcula a sala e sobe pelos ancestrais até o resumo parar de mudar */
+void atualizarResumos(Sala *s) {
+    while (s) {
+        MascaraPistas novo = mascaraDaSala(s)
+                           | (s->esquerda ? s->esquerda->resumo : 0)
+                           | (s->direita ? s->direita->resumo : 0);
+        if (novo == s->resumo) break;
+        s->resumo = novo;
+        s = s->pai;
+    }
+}
+
+/* atualizarSalasComPista - atualiza os resumos a partir de cada sala que contém 'pista'
+   (usada quando a pista entra no catálogo depois de calcularResumos) */
+void atualizarSalasComPista(Sala *raiz, const char *pista) {
+    if (!raiz) return;
+    atualizarSalasComPista(raiz->esquerda, pista);
+    atualizarSalasComPista(raiz->direita, pista);
+    if (strcmp(raiz->pista, pista) == 0) atualizarResumos(raiz);
+}
+
+/* conectarSalas - liga 'filho' à esquerda ('e') ou direita ('d') de 'pai' e atualiza os resumos.
+   Se 'filho' já estava ligado a outra sala, é desligado dela antes. */
+void conectarSalas(Sala *pai, Sala *filho, char lado) {
+    Sala **link = (lado == 'e') ? &pai->esquerda : &pai->direita;
+    if (*link == filho) return;
+    if (filho && filho->pai) {
+        Sala *antigo = filho->pai;
+        if (antigo->esquerda == filho) antigo->esquerda = NULL;
+        else antigo->direita = NULL;
+        filho->pai = NULL;
+        atualizarResumos(antigo);
+    }
+    if (*link) (*link)->pai = NULL;
+    *link = filho;
+    if (filho) {
+        filho->pai = pai;
+        atualizarResumos(filho);
+    }
+    atualizarResumos(pai);
+}
+
+/* definirPistaSala - troca a pista de uma sala e atualiza os resumos dos ancestrais
+   (toda escrita em Sala::pista passa por aqui, inclusive em criarSala) */
+void definirPistaSala(Sala *s, const char *pista) {
+    strncpy(s->pista, pista, sizeof(s->pista)-1);
+    s->pista[sizeof(s->pista)-1] = '\0';
+    atualizarResumos(s);
+}
+
+/* pistasNoRamo - pistas distintas contra o suspeito 'idSuspeito' na subárvore 'ramo' */
+int pistasNoRamo(const Sala *ramo, int idSuspeito) {
+    if (!ramo) return 0;
+    return contarBits(ramo->resumo & pistasDoSuspeito[idSuspeito]);
+}
+
+/* exibirDicas - mostra, por suspeito, quantas pistas existem em cada caminho a partir da sala */
+void exibirDicas(const Sala *atual) {
+    if (!dicasDisponiveis) {
+        printf("\nDicas indisponíveis: o catálogo passa de %d pistas ou %d suspeitos.\n", MAX_PISTAS, MAX_SUSPEITOS);
+        return;
+    }
+    printf("\nEvidências por caminho a partir de '%s':\n", atual->nome);
+    for (int i = 0; i < totalSuspeitos; ++i) {
+        printf("  %-10s esquerda: %d   direita: %d\n", nomesSuspeitos[i],
+               pistasNoRamo(atual->esquerda, i), pistasNoRamo(atual->direita, i));
+    }
+}
+
+/* =========================
+   DIÁRIO DE SESSÃO (journal binário, só acréscimo)
+   ------------------------------------------------
+   Formato: cabeçalho "DQJ1" seguido de registros [tipo:1][tamanho:1][dados].
+   Cada movimento é entregue ao sistema operacional com uma única escrita
+   (sobrevive à morte do processo), mas o fsync é feito em lote: a cada
+   JOURNAL_LOTE eventos e nos pontos de decisão (acusação e fim da sessão),
+   então mover-se entre salas não espera pelo disco.
+   Um registro incompleto no fim do arquivo (queda no meio da escrita)
+   é ignorado na leitura. A compactação reescreve o arquivo apenas com a
+   sessão em aberto: salas distintas visitadas e, por último, a sala atual.
+   ========================= */
+#define JOURNAL_ARQUIVO "detective_quest.dqj"
+#define JOURNAL_MAGICO "DQJ1"
+#define JOURNAL_BUFFER 4096
+#define JOURNAL_LOTE 16          // eventos por fsync (group commit)
+#define JOURNAL_COMPACTAR 256    // registros no arquivo antes de compactar
+#define JOURNAL_MAX_SALAS 64
+
+enum { J_INICIO = 1, J_SALA = 2, J_ACUSACAO = 3, J_FIM = 4 };
+
+typedef struct Journal {
+    char caminho[256];
+    FILE *arq;                          // NULL = diário desativado
+    unsigned char buffer[JOURNAL_BUFFER];
+    size_t usado;
+    int pendentes;                      // eventos ainda sem fsync
+    int registros;                      // registros desde a última compactação
+    int emSessao;                       // há uma sessão iniciada e não encerrada
+    Sala *visitadas[JOURNAL_MAX_SALAS]; // salas distintas da sessão, em ordem de visita
+    int totalVisitadas;
+    int avisouLimite;                   // aviso de JOURNAL_MAX_SALAS já exibido nesta sessão
+    Sala *atual;                        // última sala registrada
+} Journal;
+
+Journal diario;
+
+/* buscarSalaPorNome - localiza uma sala do mapa pelo nome (usado na leitura do diário) */
+Sala* buscarSalaPorNome(Sala *raiz, const char *nome) {
+    if (!raiz) return NULL;
+    if (strcmp(raiz->nome, nome) == 0) return raiz;
+    Sala *s = buscarSalaPorNome(raiz->esquerda, nome);
+    return s ? s : buscarSalaPorNome(raiz->direita, nome);
+}
+
+/* journalDesativar - avisa a falha, fecha o arquivo e segue o jogo sem diário */
+void journalDesativar(Journal *j, const char *operacao) {
+    fprintf(stderr, "Aviso: falha ao %s o diário '%s' (%s); o progresso não será mais salvo.\n",
+            operacao, j->caminho, strerror(errno));
+    if (j->arq) fclose(j->arq);
+    j->arq = NULL;
+    j->usado = 0;
+    j->pendentes = 0;
+}
+
+/* journalDescarregar - envia o buffer ao arquivo; com 'sincronizar', força o fsync do lote.
+   Retorna 0 (e desativa o diário) se a escrita ou a sincronização falhar. */
+int journalDescarregar(Journal *j, int sincronizar) {
+    if (!j->arq) return 0;
+    if (j->usado > 0) {
+        if (fwrite(j->buffer, 1, j->usado, j->arq) != j->usado) {
+            journalDesativar(j, "gravar");
+            return 0;
+        }
+        j->usado = 0;
+    }
+    if (fflush(j->arq) != 0) {
+        journalDesativar(j, "gravar");
+        return 0;
+    }
+    if (sincronizar && j->pendentes > 0) {
+        if (sincronizarArquivo(fileno(j->arq)) != 0) {
+            journalDesativar(j, "sincronizar");
+            return 0;
+        }
+        j->pendentes = 0;
+    }
+    return 1;
+}
+
+/* substituirArquivo - troca 'destino' por 'origem' de forma atômica e durável.
+   Retorna 0 só se a troca falhar; se apenas o fsync do diretório falhar, o arquivo
+   já foi trocado, então isso vira um aviso. */
+int substituirArquivo(const char *origem, const char *destino) {
+#ifdef _WIN32
+    return MoveFileExA(origem, destino, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    if (rename(origem, destino) != 0) return 0;
+
+    // fsync do diretório: sem ele, o próprio rename pode se perder em uma queda
+    char dir[256];
+    strncpy(dir, destino, sizeof(dir)-1);
+    dir[sizeof(dir)-1] = '\0';
+    char *barra = strrchr(dir, '/');
+    if (!barra) strcpy(dir, ".");
+    else if (barra == dir) dir[1] = '\0';
+    else *barra = '\0';
+
+    int fd = open(dir, O_RDONLY);
+    if (fd < 0 || (fsync(fd) != 0 && errno != EINVAL))   // EINVAL: sistema de arquivos sem fsync de diretório
+        fprintf(stderr, "Aviso: falha ao sincronizar o diretório '%s' (%s); a compactação do diário "
+                        "pode se perder em uma queda de energia.\n", dir, strerror(errno));
+    if (fd >= 0) close(fd);
+    return 1;
+#endif
+}
+
+/* journalGravar - acrescenta um registro ao buffer (texto pode ser NULL) */
+void journalGravar(Journal *j, unsigned char tipo, const char *texto) {
+    if (!j->arq) return;
+    size_t n = texto ? strlen(texto) : 0;
+    if (n > 255) n = 255;
+    if (JOURNAL_BUFFER - j->usado < n + 2) journalDescarregar(j, 0);
+    j->buffer[j->usado++] = tipo;
+    j->buffer[j->usado++] = (unsigned char) n;
+    memcpy(j->buffer + j->usado, texto ? texto : "", n);
+    j->usado += n;
+    j->registros++;
+    if (++j->pendentes >= JOURNAL_LOTE) journalDescarregar(j, 1);
+}
+
+/* journalAplicarSala - atualiza o estado em memória da sessão com a sala visitada */
+void journalAplicarSala(Journal *j, Sala *s) {
+    j->atual = s;
+    for (int i = 0; i < j->totalVisitadas; ++i)
+        if (j->visitadas[i] == s) return;
+    if (j->totalVisitadas < JOURNAL_MAX_SALAS) {
+        j->visitadas[j->totalVisitadas++] = s;
+    } else if (!j->avisouLimite) {
+        fprintf(stderr, "Aviso: mais de %d salas visitadas; as pistas das salas excedentes "
+                        "não serão recuperadas ao retomar a sessão.\n", JOURNAL_MAX_SALAS);
+        j->avisouLimite = 1;
+    }
+}
+
+/* journalCompactar - reescreve o diário só com a sessão em aberto (arquivo temporário + rename) */
+void journalCompactar(Journal *j) {
+    char tmp[sizeof(j->caminho) + 4];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", j->caminho);
+
+    journalDescarregar(j, 0);
+    if (j->arq) { fclose(j->arq); j->arq = NULL; }
+
+    FILE *f = fopen(tmp, "wb");
+    if (!f) {   // sem permissão de escrita: segue sem diário
+        journalDesativar(j, "criar");
+        return;
+    }
+    j->arq = f;
+    j->usado = 0;
+    j->registros = 0;
+    memcpy(j->buffer, JOURNAL_MAGICO, 4);
+    j->usado = 4;
+    if (j->emSessao) {
+        journalGravar(j, J_INICIO, NULL);
+        for (int i = 0; i < j->totalVisitadas; ++i)
+            if (j->visitadas[i] != j->atual) journalGravar(j, J_SALA, j->visitadas[i]->nome);
+        if (j->atual) journalGravar(j, J_SALA, j->atual->nome);
+    }
+    j->pendentes = 1;
+    if (!journalDescarregar(j, 1)) {   // o arquivo temporário já foi fechado
+        remove(tmp);
+        return;
+    }
+    j->arq = NULL;
+    if (fclose(f) != 0) {
+        journalDesativar(j, "gravar");
+        remove(tmp);
+        return;
+    }
+
+    if (!substituirArquivo(tmp, j->caminho)) {
+        journalDesativar(j, "compactar");
+        remove(tmp);
+        return;
+    }
+    j->arq = fopen(j->caminho, "ab");
+    if (!j->arq) journalDesativar(j, "reabrir");
+}
+
+/* journalAbrir - lê o diário existente, recupera a sessão em aberto (se houver) e o compacta.
+   Um arquivo com esse nome que não comece com JOURNAL_MAGICO é preservado: o diário
+   fica desativado em vez de sobrescrevê-lo. */
+void journalAbrir(Journal *j, const char *caminho, Sala *mapa) {
+    memset(j, 0, sizeof(*j));
+    strncpy(j->caminho, caminho, sizeof(j->caminho)-1);
+
+    FILE *f = fopen(caminho, "rb");
+    if (f) {
+        char magico[4];
+        size_t lidos = fread(magico, 1, 4, f);
+        if (lidos > 0 && (lidos < 4 || memcmp(magico, JOURNAL_MAGICO, 4) != 0)) {
+            fprintf(stderr, "Aviso: '%s' não é um diário do Detective Quest; o arquivo foi mantido "
+                            "e o progresso não será salvo.\n", caminho);
+            fclose(f);
+            return;
+        }
+        if (lidos == 4) {
+            int tipo, tam;
+            char texto[256];
+            while ((tipo = fgetc(f)) != EOF && (tam = fgetc(f)) != EOF) {
+                if (fread(texto, 1, (size_t) tam, f) != (size_t) tam) break;   // registro truncado
+                texto[tam] = '\0';
+                if (tipo == J_INICIO) {
+                    j->emSessao = 1;
+                    j->totalVisitadas = 0;
+                    j->avisouLimite = 0;
+                    j->atual = NULL;
+                } else if (tipo == J_SALA && j->emSessao) {
+                    Sala *s = buscarSalaPorNome(mapa, texto);
+                    if (s) journalAplicarSala(j, s);
+                } else if (tipo == J_FIM) {
+                    j->emSessao = 0;
+                } else if (tipo != J_ACUSACAO) {
+                    break;   // registro desconhecido: descarta o restante
+                }
+            }
+        }
+        fclose(f);
+    }
+    if (!j->atual) j->emSessao = 0;   // sessão sem nenhuma sala não tem o que retomar
+
+    journalCompactar(j);
+}
+
+/* journalIniciar - começa uma nova sessão no diário */
+void journalIniciar(Journal *j) {
+    j->emSessao = 1;
+    j->totalVisitadas = 0;
+    j->avisouLimite = 0;
+    j->atual = NULL;
+    journalGravar(j, J_INICIO, NULL);
+}
+
+/* journalSala - registra a entrada em uma sala; compacta se o diário crescer demais */
+void journalSala(Journal *j, Sala *s) {
+    journalAplicarSala(j, s);
+    journalGravar(j, J_SALA, s->nome);
+    if (j->registros >= JOURNAL_COMPACTAR) journalCompactar(j);
+    else journalDescarregar(j, 0);
+}
+
+/* journalAcusacao - registra o suspeito acusado e confirma o lote no disco */
+void journalAcusacao(Journal *j, const char *acusado) {
+    journalGravar(j, J_ACUSACAO, acusado);
+    journalDescarregar(j, 1);
+}
+
+/* journalFim - encerra a sessão; não haverá nada a retomar */
+void journalFim(Journal *j) {
+    j->emSessao = 0;
+    journalGravar(j, J_FIM, NULL);
+    journalDescarregar(j, 1);
+}
+
+/* journalDescartar - abandona a sessão em aberto sem retomá-la */
+void journalDescartar(Journal *j) {
+    j->emSessao = 0;
+    journalCompactar(j);
+}
+
+/* journalReproduzir - reconstrói a árvore de pistas da sessão em aberto sem o laço interativo.
+   Retorna a sala onde o jogador estava. */
+Sala* journalReproduzir(Journal *j, PistaNode **arvorePistas) {
+    for (int i = 0; i < j->totalVisitadas; ++i) {
+        if (j->visitadas[i]->pista[0] != '\0')
+            *arvorePistas = inserirPista(*arvorePistas, j->visitadas[i]->pista);
+    }
+    return j->atual;
+}
+
+/* journalFechar - grava o que estiver pendente e fecha o arquivo */
+void journalFechar(Journal *j) {
+    journalDescarregar(j, 1);
+    if (j->arq) fclose(j->arq);
+    j->arq = NULL;
 }
 
 /* =========================
    FUNÇÃO: explorarSalas
    ----------------------
    Navega pela árvore de salas, coleta pistas automaticamente
-   e insere na BST de pistas.
+   e insere na BST de pistas. Cada sala visitada é registrada no diário.
    ========================= */
 void explorarSalas(Sala *inicio, PistaNode **arvorePistas) {
     Sala *atual = inicio;
     char escolha;
 
     printf("\nVocê entrou na '%s'.\n", atual->nome);
+    journalSala(&diario, atual);
 
     while (1) {
         // Exibir e coletar pista, se houver
@@ -189,7 +967,7 @@ void explorarSalas(Sala *inicio, PistaNode **arvorePistas) {
             printf("Pista encontrada: \"%s\"\n", atual->pista);
             *arvorePistas = inserirPista(*arvorePistas, atual->pista);
             // mostrar para qual suspeito essa pista aponta (consulta na hash)
-            char *s = encontrarSuspeito(atual->pista);
+            const char *s = encontrarSuspeito(atual->pista);
             if (s) printf("   (Essa pista indica: %s)\n", s);
         } else {
             printf("Nenhuma pista nesta sala.\n");
@@ -199,6 +977,7 @@ void explorarSalas(Sala *inicio, PistaNode **arvorePistas) {
         printf("\nCaminhos disponíveis a partir de '%s':\n", atual->nome);
         if (atual->esquerda) printf("  (e) Ir para '%s' (esquerda)\n", atual->esquerda->nome);
         if (atual->direita)  printf("  (d) Ir para '%s' (direita)\n", atual->direita->nome);
+        printf("  (p) Ver evidências por caminho\n");
         printf("  (s) Sair da exploração\n");
 
         printf("\nEscolha sua ação: ");
@@ -207,6 +986,7 @@ void explorarSalas(Sala *inicio, PistaNode **arvorePistas) {
         if (escolha == 'e' || escolha == 'E') {
             if (atual->esquerda) {
                 atual = atual->esquerda;
+                journalSala(&diario, atual);
                 printf("\nVocê foi para '%s'.\n", atual->nome);
             } else {
                 printf("Não há caminho à esquerda!\n");
@@ -214,10 +994,13 @@ void explorarSalas(Sala *inicio, PistaNode **arvorePistas) {
         } else if (escolha == 'd' || escolha == 'D') {
             if (atual->direita) {
                 atual = atual->direita;
+                journalSala(&diario, atual);
                 printf("\nVocê foi para '%s'.\n", atual->nome);
             } else {
                 printf("Não há caminho à direita!\n");
             }
+        } else if (escolha == 'p' || escolha == 'P') {
+            exibirDicas(atual);
         } else if (escolha == 's' || escolha == 'S') {
             printf("\nVocê encerrou a exploração.\n");
             break;
@@ -259,6 +1042,7 @@ void verificarSuspeitoFinal(PistaNode *arvorePistas) {
         printf("Nenhum nome fornecido.\n");
         return;
     }
+    journalAcusacao(&diario, acusado);
 
     int contador = contarPistasParaSuspeito(arvorePistas, acusado);
     printf("\n%s recebeu %d pista(s) que o ligam ao crime.\n", acusado, contador);
@@ -286,8 +1070,10 @@ void liberarSalas(Sala *raiz) {
    FUNÇÃO: main
    ========================= */
 int main(void) {
+#ifndef CASO_FIXO
     /* Inicializar tabela hash nula */
     for (int i=0;i<HASH_SIZE;i++) hashTable[i] = NULL;
+#endif
 
     /* Criar mapa fixo da mansão (árvore binária) com pistas estáticas */
     // Exemplo de mapa:
@@ -308,41 +1094,86 @@ int main(void) {
     Sala *escritorio = criarSala("Escritório", "Um bilhete com a assinatura 'Marta R.'");
 
     // montar conexões
-    hall->esquerda = salaEstar;
-    hall->direita = cozinha;
-    salaEstar->esquerda = biblioteca;
-    salaEstar->direita = jardim;
-    cozinha->direita = porao;
-    porao->direita = escritorio;
-
-    /* Criar tabela hash que associa cada pista a um suspeito */
-    // Observação: aqui associamos as strings exatas das pistas criadas acima
-    inserirNaHash("A chave do escritório está faltando.", "Eleanor");
-    inserirNaHash("Um retrato com uma mancha vermelha.", "Carlos");
-    inserirNaHash("Pegadas de lama perto da janela.", "Marta R.");
-    inserirNaHash("Página rasgada mencionando \"Eleanor\".", "Eleanor");
-    inserirNaHash("Um lenço com as iniciais 'M.R.'", "Marta R.");
-    inserirNaHash("Marcas de ferramentas próximas ao cofre.", "Carlos");
-    inserirNaHash("Um bilhete com a assinatura 'Marta R.'", "Marta R.");
-
-    /* Árvore BST de pistas coletadas começa vazia */
-    PistaNode *arvorePistas = NULL;
+    conectarSalas(hall, salaEstar, 'e');
+    conectarSalas(hall, cozinha, 'd');
+    conectarSalas(salaEstar, biblioteca, 'e');
+    conectarSalas(salaEstar, jardim, 'd');
+    conectarSalas(cozinha, porao, 'd');
+    conectarSalas(porao, escritorio, 'd');
+
+#ifdef CASO_FIXO
+    /* Tabela gerada previamente: conferida em qualquer build (7 hashes) */
+    if (!verificarCatalogoFixo(hall)) {
+        fprintf(stderr, "Erro: catálogo fixo inconsistente; gere-o novamente com -DGERAR_CASO_FIXO\n");
+        exit(EXIT_FAILURE);
+    }
+#elif defined(GERAR_CASO_FIXO)
+    /* Apenas imprime a tabela do catálogo fixo e encerra */
+    int gerado = gerarCasoFixo();
+    liberarSalas(hall);
+    return gerado ? 0 : EXIT_FAILURE;
+#else
+    /* Criar tabela hash que associa cada pista a um suspeito (strings exatas das salas) */
+    for (int i = 0; i < TOTAL_CATALOGO; ++i)
+        inserirNaHash(catalogoCaso[i].pista, catalogoCaso[i].suspeito);
+#endif
+
+    /* Resumos de evidência por subárvore (uma passagem, após o catálogo existir) */
+    calcularResumos(hall);
 
     /* Mensagem inicial */
     printf("=== Detective Quest: Julgamento Final ===\n");
     printf("Você é o detetive. Explore a mansão, colete pistas e acuse um suspeito.\n");
-    printf("Controles: 'e' = esquerda, 'd' = direita, 's' = sair\n");
+    printf("Controles: 'e' = esquerda, 'd' = direita, 'p' = evidências por caminho, 's' = sair\n");
+
+    /* Diário da sessão: oferece retomar uma investigação interrompida */
+    journalAbrir(&diario, JOURNAL_ARQUIVO, hall);
+    char novamente;
+    int retomar = 0;
+    if (diario.emSessao) {
+        printf("\nHá uma investigação interrompida em '%s'. Deseja retomá-la? (s/n): ", diario.atual->nome);
+        if (scanf(" %c", &novamente) == 1 && (novamente == 's' || novamente == 'S')) retomar = 1;
+        else journalDescartar(&diario);
+    }
+
+    /* Sessões consecutivas: a arena da sessão é reaproveitada, sem malloc após a primeira */
+    do {
+        /* Árvore BST de pistas coletadas começa vazia */
+        PistaNode *arvorePistas = NULL;
+        Sala *inicio = hall;
+
+        if (retomar) {
+            /* Reconstrói as pistas já coletadas a partir do diário */
+            inicio = journalReproduzir(&diario, &arvorePistas);
+            retomar = 0;
+        } else {
+            journalIniciar(&diario);
+        }
+
+        /* Exploração interativa */
+        explorarSalas(inicio, &arvorePistas);
+
+        /* Fase de acusação: listar pistas e pedir o acusado */
+        verificarSuspeitoFinal(arvorePistas);
+        journalFim(&diario);
 
-    /* Exploração interativa */
-    explorarSalas(hall, &arvorePistas);
+        /* Descarta as pistas da sessão em O(1) */
+        liberarPistasBST(arvorePistas);
 
-    /* Fase de acusação: listar pistas e pedir o acusado */
-    verificarSuspeitoFinal(arvorePistas);
+        printf("\nDeseja iniciar uma nova investigação? (s/n): ");
+        if (scanf(" %c", &novamente) != 1) novamente = 'n';
+    } while (novamente == 's' || novamente == 'S');
 
     /* Limpeza de memória */
-    liberarPistasBST(arvorePistas);
+    journalFechar(&diario);
+#ifndef CASO_FIXO
     liberarHash();
+#endif
     liberarSalas(hall);
+    arenaLiberar(&arenaSessao);
+#ifndef CASO_FIXO
+    arenaLiberar(&arenaCaso);
+#endif
 
     printf("\nObrigado por jogar Detective Quest! Até a próxima investigação.\n");
 